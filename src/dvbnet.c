@@ -10,6 +10,8 @@
 #include <math.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/stat.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 
 #include <net/if.h>
@@ -17,22 +19,60 @@
 #include <sys/socket.h>
 #include <net/if_arp.h>
 #include <netinet/in.h>
+#include <netinet/ether.h>
 
 #include <linux/dvb/net.h>
+#include <linux/dvb/frontend.h>
+#include <linux/dvb/dmx.h>
 
 #include <gtk/gtk.h>
+#include <glib-unix.h>
 
 #define DVBNET_TYPE_APPLICATION dvbnet_get_type()
 
+/* Interfaces per net device, see drivers/media/dvb-core/dvb_net.c */
+#define DVB_NET_DEVICES_MAX 10
+/* Multicast addresses per interface, above this the kernel falls back to all-multi */
+#define DVB_NET_MULTICAST_MAX 10
+
+/* Adapters & net devices are looked for in 0 .. DVBNET_DEV_MAX */
+#define DVBNET_DEV_MAX 16
+
+/* Interval of the placement load & pid measurement */
+#define DVBNET_PLACE_MS 100
+
+/* Pid input & accepted rate: interval, demux read period and buffer */
+#define DVBNET_METER_MS   1000
+#define DVBNET_METER_READ 100
+#define DVBNET_METER_BUF  ( 1024 * 1024 )
+
 G_DECLARE_FINAL_TYPE ( Dvbnet, dvbnet, DVBNET, APPLICATION, GtkApplication )
 
 enum mode 
 {
 	SET_IP,
 	SET_MAC,
+	SET_RX,
+	SET_MCAST,
 	DEL_IF
 };
 
+enum rx_mode
+{
+	RX_FILTER,
+	RX_ALL_MULTI,
+	RX_PROMISC
+};
+
+/* Placement result, the mux matches rank in this order */
+enum place
+{
+	PLACE_NONE,
+	PLACE_NO_LOCK,
+	PLACE_LOCK,
+	PLACE_PID
+};
+
 enum cols_n
 {
 	COL_NUM,
@@ -41,9 +81,56 @@ enum cols_n
 	COL_ECPS,
 	COL_STR_IP,
 	COL_STR_MAC,
+	COL_RX_MODE,
+	COL_STR_MCAST,
+	COL_STR_RX,
 	NUM_COLS
 };
 
+/* Last known state of an interface, re-applied by the supervisor */
+typedef struct _DvbnetIf DvbnetIf;
+
+struct _DvbnetIf
+{
+	uint16_t pid;
+	uint8_t  adapter, net, if_num, encaps, rx_mode;
+	gboolean up;
+
+	char *ip, *mac;
+	GList *mcast;
+};
+
+typedef struct _DvbnetRestore DvbnetRestore;
+
+struct _DvbnetRestore
+{
+	Dvbnet *dvbnet;
+
+	guint src_id;
+	uint8_t adapter, net, tries;
+	int64_t start;
+};
+
+typedef struct _DvbnetPlace DvbnetPlace;
+
+struct _DvbnetPlace
+{
+	uint16_t pid, n;
+
+	struct _DvbnetPlaceDev { uint8_t adapter, net, count, mux; int demux_fd; uint64_t bytes; } dev[( DVBNET_DEV_MAX + 1 ) * ( DVBNET_DEV_MAX + 1 )];
+};
+
+typedef struct _DvbnetMeter DvbnetMeter;
+
+struct _DvbnetMeter
+{
+	char net_name[20];
+	int demux_fd, row;
+	gboolean overflow;
+	int64_t start;
+	uint64_t ts_bytes, rx_bytes, rx_packets;
+};
+
 struct _Dvbnet
 {
 	GtkApplication  parent_instance;
@@ -51,10 +138,27 @@ struct _Dvbnet
 	GtkWindow *window;
 	GtkEntry *entry_ip;
 	GtkEntry *entry_mac;
+	GtkEntry *entry_mcast;
 	GtkTreeView *treeview;
+	GtkSpinButton *spin_adapter;
+	GtkSpinButton *spin_net;
+	GtkLabel *label_place;
+
+	GList *ifs;
+	GHashTable *lives;
+	GHashTable *monitors;
+	GHashTable *restores;
+	guint refresh_id;
+
+	DvbnetPlace *place;
+	guint place_id;
+
+	GList *meters;
+	guint meter_id, meter_ticks;
 
 	uint16_t net_pid;
-	uint8_t  dvb_adapter, dvb_net, if_num, net_ens;
+	uint8_t  dvb_adapter, dvb_net, if_num, net_ens, rx_mode;
+	gboolean net_auto;
 };
 
 G_DEFINE_TYPE (Dvbnet, dvbnet, GTK_TYPE_APPLICATION)
@@ -90,260 +194,1595 @@ static void dvbnet_message_dialog ( const char *error, const char *file_or_info,
 	gtk_widget_destroy ( GTK_WIDGET ( dialog ) );
 }
 
-static int dvbnet_open ( Dvbnet *dvbnet )
+/* The net device has a single user: a short open elsewhere ( supervisor, dvbnet ) is waited out */
+static int dvbnet_open_dev ( uint8_t adapter, uint8_t net )
 {
 	char file[80] = {};
-	sprintf ( file, "/dev/dvb/adapter%u/net%u", dvbnet->dvb_adapter, dvbnet->dvb_net );
+	sprintf ( file, "/dev/dvb/adapter%u/net%u", adapter, net );
+
+	int fd = -1;
+
+	uint8_t i = 0; for ( i = 0; i < 10; i++ )
+	{
+		fd = open ( file, O_RDWR );
+
+		if ( fd != -1 || errno != EBUSY ) break;
+
+		g_usleep ( 5000 );
+	}
+
+	return fd;
+}
 
-	int fd = open ( file, O_RDWR );
+static int dvbnet_open ( Dvbnet *dvbnet )
+{
+	int fd = dvbnet_open_dev ( dvbnet->dvb_adapter, dvbnet->dvb_net );
 
 	if ( fd == -1 )
 	{
+		char file[80] = {};
+		sprintf ( file, "/dev/dvb/adapter%u/net%u", dvbnet->dvb_adapter, dvbnet->dvb_net );
+
 		perror ( "Open net device failed" );
 		dvbnet_message_dialog ( file, g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
 	}
 
-	return fd;
+	return fd;
+}
+
+/* Interface name as the kernel makes it: dvbA_N on net device 0, dvbANI on the others */
+static void dvbnet_if_name ( char *net_name, uint8_t adapter, uint8_t net, uint8_t if_num )
+{
+	if ( net )
+		sprintf ( net_name, "dvb%u%u%u", adapter, net, if_num );
+	else
+		sprintf ( net_name, "dvb%u_%u", adapter, if_num );
+}
+
+static int dvbnet_get_if_info ( int fd, uint8_t ifnum, uint16_t *pid, uint8_t *encaps )
+{
+	struct dvb_net_if info;
+
+	memset ( &info, 0, sizeof(struct dvb_net_if) );
+	info.if_num = ifnum;
+
+	int ret = ioctl ( fd, NET_GET_IF, &info );
+
+	if ( ret == -1 ) return ret;
+
+	*pid = info.pid;
+	*encaps = info.feedtype;
+
+	return 0;
+}
+
+static char * dvbnet_get_mac_ip ( const char *net_name, uint8_t mac_ip )
+{
+	struct ifreq ifr;
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return NULL; }
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+	strcpy ( ifr.ifr_name, net_name  );
+
+	if ( mac_ip )
+	{
+		if ( ioctl ( fd, SIOCGIFHWADDR, &ifr ) < 0 ) { close ( fd ); return NULL; }
+
+		char *ret = malloc ( 18 );
+
+		uint8_t i = 0; for ( i = 0; i < 6; ++i )
+			snprintf ( ret + (i*3), (size_t)(18 - (i*3)), "%02x%s", (uint8_t)ifr.ifr_addr.sa_data[i], ":" );
+
+		close ( fd );
+
+		return ret;
+	}
+	else
+	{
+		if ( ioctl ( fd, SIOCGIFADDR, &ifr ) < 0 ) { close ( fd ); return NULL; }
+
+		char *ret = g_strdup ( inet_ntoa ( ( (struct sockaddr_in *)&ifr.ifr_addr )->sin_addr ) );
+
+		close ( fd );
+
+		return ret;
+	}
+
+	return NULL;
+}
+
+/* FALSE with errno set, EINVAL for a malformed MAC */
+static gboolean dvbnet_set_mac ( const char *net_name, const char *mac )
+{
+	struct ifreq ifr;
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+
+	int ret = sscanf ( mac, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+		&ifr.ifr_hwaddr.sa_data[0],
+		&ifr.ifr_hwaddr.sa_data[1],
+		&ifr.ifr_hwaddr.sa_data[2],
+		&ifr.ifr_hwaddr.sa_data[3],
+		&ifr.ifr_hwaddr.sa_data[4],
+		&ifr.ifr_hwaddr.sa_data[5] );
+
+	if ( ret != 6 ) { errno = EINVAL; return FALSE; }
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return FALSE; }
+
+	strcpy ( ifr.ifr_name, net_name );
+
+	ifr.ifr_hwaddr.sa_family = ARPHRD_ETHER;
+
+	ret = ioctl ( fd, SIOCSIFHWADDR, &ifr );
+
+	if ( ret < 0 ) perror ( "SIOCSIFHWADDR" );
+
+	close ( fd );
+
+	return ( ret == 0 );
+}
+
+/* FALSE with errno set, EINVAL for a malformed address */
+static gboolean dvbnet_set_ip ( const char *net_name, const char *host )
+{
+	struct ifreq ifr;
+	struct sockaddr_in inet_addr;
+
+	memset ( &inet_addr, 0, sizeof(inet_addr) );
+	inet_addr.sin_family = AF_INET;
+
+	if ( inet_pton ( AF_INET, host, &(inet_addr.sin_addr) ) != 1 ) { errno = EINVAL; return FALSE; }
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return FALSE; }
+
+	bzero  ( ifr.ifr_name, IFNAMSIZ );
+	strcpy ( ifr.ifr_name, net_name );
+
+	memcpy ( &(ifr.ifr_addr), &inet_addr, sizeof (struct sockaddr) );
+
+	int ret = ioctl ( fd, SIOCSIFADDR, &ifr );
+
+	if ( ret < 0 ) perror ( "SIOCSIFADDR" );
+
+	close ( fd );
+
+	return ( ret == 0 );
+}
+
+static gboolean dvbnet_get_if_up ( const char *net_name )
+{
+	struct ifreq ifr;
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return FALSE; }
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+	strcpy ( ifr.ifr_name, net_name );
+
+	int ret = ioctl ( fd, SIOCGIFFLAGS, &ifr );
+
+	close ( fd );
+
+	return ( ret == 0 && ( ifr.ifr_flags & IFF_UP ) );
+}
+
+static void dvbnet_set_if_up ( const char *net_name, gboolean up )
+{
+	struct ifreq ifr;
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return; }
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+	strcpy ( ifr.ifr_name, net_name );
+
+	ioctl ( fd, SIOCGIFFLAGS, &ifr );
+
+	if ( up ) ifr.ifr_flags |= IFF_UP; else ifr.ifr_flags &= ~ IFF_UP;
+
+	if ( ioctl ( fd, SIOCSIFFLAGS, &ifr ) < 0 ) perror ( "SIOCSIFFLAGS" );
+
+	close ( fd );
+}
+
+static uint8_t dvbnet_get_rx_mode ( const char *net_name )
+{
+	struct ifreq ifr;
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return RX_FILTER; }
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+	strcpy ( ifr.ifr_name, net_name );
+
+	int ret = ioctl ( fd, SIOCGIFFLAGS, &ifr );
+
+	close ( fd );
+
+	if ( ret < 0 ) return RX_FILTER;
+
+	return ( ifr.ifr_flags & IFF_PROMISC ) ? RX_PROMISC : ( ifr.ifr_flags & IFF_ALLMULTI ) ? RX_ALL_MULTI : RX_FILTER;
+}
+
+/* Filter: unicast & multicast list, All-multi: unicast & all multicast, Promisc: everything */
+static gboolean dvbnet_set_rx_mode ( const char *net_name, uint8_t rx_mode )
+{
+	struct ifreq ifr;
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return FALSE; }
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+	strcpy ( ifr.ifr_name, net_name );
+
+	int ret = ioctl ( fd, SIOCGIFFLAGS, &ifr );
+
+	if ( ret < 0 ) { perror ( "SIOCGIFFLAGS" ); close ( fd ); return FALSE; }
+
+	ifr.ifr_flags &= ~ ( IFF_PROMISC | IFF_ALLMULTI );
+
+	if ( rx_mode == RX_ALL_MULTI ) ifr.ifr_flags |= IFF_ALLMULTI;
+	if ( rx_mode == RX_PROMISC   ) ifr.ifr_flags |= IFF_PROMISC;
+
+	ret = ioctl ( fd, SIOCSIFFLAGS, &ifr );
+
+	if ( ret < 0 ) perror ( "SIOCSIFFLAGS" );
+
+	close ( fd );
+
+	return ( ret == 0 );
+}
+
+/* Multicast MAC from a MAC or an IPv4 group ( 01:00:5e + low 23 bits ) */
+static gboolean dvbnet_mcast_parse ( const char *str, char mac[18] )
+{
+	uint8_t hw[6] = {};
+	struct in_addr addr;
+
+	if ( inet_pton ( AF_INET, str, &addr ) == 1 )
+	{
+		uint32_t group = ntohl ( addr.s_addr );
+
+		if ( !IN_MULTICAST ( group ) ) return FALSE;
+
+		hw[0] = 0x01; hw[1] = 0x00; hw[2] = 0x5e;
+		hw[3] = ( group >> 16 ) & 0x7f;
+		hw[4] = ( group >> 8  ) & 0xff;
+		hw[5] = group & 0xff;
+	}
+	else
+	{
+		struct ether_addr *ether = ether_aton ( str );
+
+		if ( ether == NULL || !( ether->ether_addr_octet[0] & 0x01 ) ) return FALSE;
+
+		memcpy ( hw, ether->ether_addr_octet, 6 );
+	}
+
+	sprintf ( mac, "%02x:%02x:%02x:%02x:%02x:%02x", hw[0], hw[1], hw[2], hw[3], hw[4], hw[5] );
+
+	return TRUE;
+}
+
+static gboolean dvbnet_set_mcast ( const char *net_name, const char *mac, gboolean add )
+{
+	struct ifreq ifr;
+
+	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+
+	if ( fd < 0 ) { perror ( "socket" ); return FALSE; }
+
+	memset ( &ifr, 0x00, sizeof(ifr) );
+	strcpy ( ifr.ifr_name, net_name );
+
+	sscanf ( mac, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+		&ifr.ifr_hwaddr.sa_data[0],
+		&ifr.ifr_hwaddr.sa_data[1],
+		&ifr.ifr_hwaddr.sa_data[2],
+		&ifr.ifr_hwaddr.sa_data[3],
+		&ifr.ifr_hwaddr.sa_data[4],
+		&ifr.ifr_hwaddr.sa_data[5] );
+
+	ifr.ifr_hwaddr.sa_family = AF_UNSPEC;
+
+	int ret = ioctl ( fd, ( add ) ? SIOCADDMULTI : SIOCDELMULTI, &ifr );
+
+	if ( ret < 0 ) perror ( ( add ) ? "SIOCADDMULTI" : "SIOCDELMULTI" );
+
+	close ( fd );
+
+	return ( ret == 0 );
+}
+
+/* Multicast list from /proc/net/dev_mcast, only_global: added with SIOCADDMULTI */
+static GList * dvbnet_get_mcast ( const char *net_name, gboolean only_global )
+{
+	char *text = NULL;
+
+	if ( !g_file_get_contents ( "/proc/net/dev_mcast", &text, NULL, NULL ) ) return NULL;
+
+	GList *list = NULL;
+	char **lines = g_strsplit ( text, "\n", -1 );
+
+	guint i = 0; for ( i = 0; lines[i] != NULL; i++ )
+	{
+		char name[IFNAMSIZ + 1] = {}, hex[13] = {};
+		guint users = 0, global = 0;
+
+		if ( sscanf ( lines[i], "%*d %16s %u %u %12s", name, &users, &global, hex ) != 4 ) continue;
+
+		if ( !g_str_equal ( name, net_name ) || strlen ( hex ) != 12 || ( only_global && !global ) ) continue;
+
+		list = g_list_append ( list, g_strdup_printf ( "%.2s:%.2s:%.2s:%.2s:%.2s:%.2s", hex, hex + 2, hex + 4, hex + 6, hex + 8, hex + 10 ) );
+	}
+
+	g_strfreev ( lines );
+	g_free ( text );
+
+	return list;
+}
+
+static const char * dvbnet_get_rx_mode_str ( const char *net_name, guint mcast_count )
+{
+	uint8_t rx_mode = dvbnet_get_rx_mode ( net_name );
+
+	if ( rx_mode == RX_PROMISC ) return "Promisc";
+
+	if ( rx_mode == RX_ALL_MULTI || mcast_count > DVB_NET_MULTICAST_MAX ) return "All-multi";
+
+	return ( mcast_count ) ? "Multi" : "Uni";
+}
+
+static uint64_t dvbnet_get_stat ( const char *net_name, const char *stat )
+{
+	char *text = NULL;
+	char *file = g_strdup_printf ( "/sys/class/net/%s/statistics/%s", net_name, stat );
+
+	uint64_t ret = 0;
+
+	if ( g_file_get_contents ( file, &text, NULL, NULL ) ) ret = g_ascii_strtoull ( text, NULL, 10 );
+
+	g_free ( text );
+	g_free ( file );
+
+	return ret;
+}
+
+/* Pes filter on the demux, readable once a TS packet with this pid arrives; buf_size 0 keeps the default buffer */
+static int dvbnet_probe_pid ( uint8_t adapter, uint8_t demux, uint16_t pid, uint32_t buf_size )
+{
+	char file[80] = {};
+	sprintf ( file, "/dev/dvb/adapter%u/demux%u", adapter, demux );
+
+	int fd = open ( file, O_RDWR | O_NONBLOCK );
+
+	if ( fd == -1 ) return -1;
+
+	if ( buf_size && ioctl ( fd, DMX_SET_BUFFER_SIZE, (unsigned long)buf_size ) == -1 ) perror ( "DMX_SET_BUFFER_SIZE" );
+
+	struct dmx_pes_filter_params filter;
+
+	memset ( &filter, 0, sizeof(filter) );
+	filter.pid      = pid;
+	filter.input    = DMX_IN_FRONTEND;
+	filter.output   = DMX_OUT_TSDEMUX_TAP;
+	filter.pes_type = DMX_PES_OTHER;
+	filter.flags    = DMX_IMMEDIATE_START;
+
+	if ( ioctl ( fd, DMX_SET_PES_FILTER, &filter ) == -1 ) { close ( fd ); return -1; }
+
+	return fd;
+}
+
+static gboolean dvbnet_probe_seen ( int fd )
+{
+	if ( fd == -1 ) return FALSE;
+
+	struct pollfd pfd = { .fd = fd, .events = POLLIN | POLLPRI };
+
+	return ( poll ( &pfd, 1, 0 ) > 0 && ( pfd.revents & ( POLLIN | POLLPRI ) ) );
+}
+
+static void dvbnet_meter_free ( DvbnetMeter *meter )
+{
+	if ( meter->demux_fd != -1 ) close ( meter->demux_fd );
+
+	g_free ( meter );
+}
+
+/* Pid input: TS tap on the demux of the net device, accepted: rx_bytes & rx_packets of the interface */
+static DvbnetMeter * dvbnet_meter_begin ( const char *net_name, uint8_t adapter, uint8_t net, uint16_t pid, int row )
+{
+	DvbnetMeter *meter = g_new0 ( DvbnetMeter, 1 );
+
+	g_strlcpy ( meter->net_name, net_name, sizeof(meter->net_name) );
+
+	/* Net device N receives from demux N */
+	meter->demux_fd   = dvbnet_probe_pid ( adapter, net, pid, DVBNET_METER_BUF );
+	meter->row        = row;
+	meter->start      = g_get_monotonic_time ();
+	meter->rx_bytes   = dvbnet_get_stat ( net_name, "rx_bytes"   );
+	meter->rx_packets = dvbnet_get_stat ( net_name, "rx_packets" );
+
+	return meter;
+}
+
+static void dvbnet_meter_read ( DvbnetMeter *meter )
+{
+	if ( meter->demux_fd == -1 ) return;
+
+	uint8_t buf[188 * 256];
+
+	ssize_t len = 0; while ( ( len = read ( meter->demux_fd, buf, sizeof(buf) ) ) != 0 )
+	{
+		if ( len > 0 ) { meter->ts_bytes += (uint64_t)len; continue; }
+
+		/* The demux buffer ran over: the input is more than counted */
+		if ( errno == EOVERFLOW ) { meter->overflow = TRUE; continue; }
+
+		break;
+	}
+}
+
+/* "Pid in / Accepted kB/s ( pkt/s )", frees the meter */
+static char * dvbnet_meter_end ( DvbnetMeter *meter )
+{
+	dvbnet_meter_read ( meter );
+
+	double ms = (double)( g_get_monotonic_time () - meter->start ) / 1000;
+
+	uint64_t rx_bytes   = dvbnet_get_stat ( meter->net_name, "rx_bytes"   );
+	uint64_t rx_packets = dvbnet_get_stat ( meter->net_name, "rx_packets" );
+
+	rx_bytes   = ( rx_bytes   > meter->rx_bytes   ) ? rx_bytes   - meter->rx_bytes   : 0;
+	rx_packets = ( rx_packets > meter->rx_packets ) ? rx_packets - meter->rx_packets : 0;
+
+	char *pid_in = ( meter->demux_fd == -1 ) ? g_strdup ( "-" ) : g_strdup_printf ( "%s%.1f", ( meter->overflow ) ? "> " : "", (double)meter->ts_bytes / ms );
+
+	char *ret = g_strdup_printf ( "%s / %.1f kB/s ( %.0f pkt/s )", pid_in, (double)rx_bytes / ms, (double)rx_packets * 1000 / ms );
+
+	g_free ( pid_in );
+	dvbnet_meter_free ( meter );
+
+	return ret;
+}
+
+/* Receive mode and multicast list */
+static const char * dvbnet_get_rx_info ( const char *net_name, char **str_mcast )
+{
+	GList *mcast = dvbnet_get_mcast ( net_name, FALSE );
+
+	GString *string = g_string_new ( NULL );
+
+	GList *list = NULL; for ( list = mcast; list != NULL; list = list->next )
+		g_string_append_printf ( string, "%s%s", ( list == mcast ) ? "" : " ", (char *)list->data );
+
+	if ( string->len == 0 ) g_string_append ( string, "None" );
+
+	*str_mcast = g_string_free ( string, FALSE );
+
+	const char *rx_mode = dvbnet_get_rx_mode_str ( net_name, g_list_length ( mcast ) );
+
+	g_list_free_full ( mcast, g_free );
+
+	return rx_mode;
+}
+
+static void dvbnet_treeview_append ( const char *name, uint8_t if_num, uint16_t pid, uint8_t encaps, const char *ip_str, const char *str_mac,
+	const char *rx_mode, const char *str_mcast, const char *str_rx, Dvbnet *dvbnet )
+{
+	GtkTreeIter iter;
+	GtkTreeModel *model = gtk_tree_view_get_model ( dvbnet->treeview );
+
+	int ind = gtk_tree_model_iter_n_children ( model, NULL );
+	if ( ind >= UINT8_MAX ) return;
+
+	char buf[20] = {};
+	sprintf ( buf, "0x%.4X", pid );
+
+	gtk_list_store_append ( GTK_LIST_STORE ( model ), &iter );
+	gtk_list_store_set    ( GTK_LIST_STORE ( model ), &iter,
+				COL_NUM, if_num,
+				COL_NAME, name,
+				COL_PID,  buf,
+				COL_ECPS, ( encaps ) ? "Ule" : "Mpe",
+				COL_STR_IP, ip_str,
+				COL_STR_MAC, str_mac,
+				COL_RX_MODE, rx_mode,
+				COL_STR_MCAST, str_mcast,
+				COL_STR_RX, str_rx,
+				-1 );
+}
+
+static void dvbnet_meter_cancel ( Dvbnet *dvbnet )
+{
+	if ( dvbnet->meter_id ) g_source_remove ( dvbnet->meter_id );
+
+	g_list_free_full ( dvbnet->meters, (GDestroyNotify)dvbnet_meter_free );
+
+	dvbnet->meters = NULL;
+	dvbnet->meter_id = 0;
+	dvbnet->meter_ticks = 0;
+}
+
+static gboolean dvbnet_meter_timeout ( Dvbnet *dvbnet )
+{
+	GList *list = NULL; for ( list = dvbnet->meters; list != NULL; list = list->next )
+		dvbnet_meter_read ( (DvbnetMeter *)list->data );
+
+	if ( ++dvbnet->meter_ticks < DVBNET_METER_MS / DVBNET_METER_READ ) return G_SOURCE_CONTINUE;
+
+	GtkTreeModel *model = gtk_tree_view_get_model ( dvbnet->treeview );
+
+	for ( list = dvbnet->meters; list != NULL; list = list->next )
+	{
+		GtkTreeIter iter;
+		DvbnetMeter *meter = (DvbnetMeter *)list->data;
+
+		gboolean valid = gtk_tree_model_iter_nth_child ( model, &iter, NULL, meter->row );
+
+		char *str_rx = dvbnet_meter_end ( meter );
+
+		if ( valid ) gtk_list_store_set ( GTK_LIST_STORE ( model ), &iter, COL_STR_RX, str_rx, -1 );
+
+		g_free ( str_rx );
+	}
+
+	g_list_free ( dvbnet->meters );
+
+	dvbnet->meters = NULL;
+	dvbnet->meter_id = 0;
+	dvbnet->meter_ticks = 0;
+
+	return G_SOURCE_REMOVE;
+}
+
+static void dvbnet_set_if_info ( Dvbnet *dvbnet )
+{
+	dvbnet_meter_cancel ( dvbnet );
+
+	int net_fd = dvbnet_open ( dvbnet );
+
+	if ( net_fd == -1 ) return;
+
+	int row = 0;
+	char net_name[20] = {};
+
+	gtk_list_store_clear ( GTK_LIST_STORE ( gtk_tree_view_get_model ( dvbnet->treeview ) ) );
+
+	uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
+	{
+		uint16_t pid = 0;
+		uint8_t encaps = 0;
+
+		int ret = dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps );
+
+		if ( ret == -1 ) continue;
+
+		dvbnet_if_name ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, ifs );
+
+		char *str_ip  = dvbnet_get_mac_ip ( net_name, 0 );
+		char *str_mac = dvbnet_get_mac_ip ( net_name, 1 );
+
+		char *str_mcast = NULL;
+		const char *rx_mode = dvbnet_get_rx_info ( net_name, &str_mcast );
+
+		dvbnet_treeview_append ( net_name, ifs, pid, encaps, ( str_ip ) ? str_ip : "None", ( str_mac ) ? str_mac : "None", rx_mode, str_mcast, "…", dvbnet );
+
+		/* Filled in when the interval is over, the window is not blocked */
+		dvbnet->meters = g_list_append ( dvbnet->meters, dvbnet_meter_begin ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, pid, row++ ) );
+
+		free ( str_ip  );
+		free ( str_mac );
+		g_free ( str_mcast );
+	}
+
+	close ( net_fd );
+
+	if ( dvbnet->meters ) dvbnet->meter_id = g_timeout_add ( DVBNET_METER_READ, (GSourceFunc)dvbnet_meter_timeout, dvbnet );
+}
+
+static int dvbnet_net_add_if ( int net_fd, uint16_t pid, uint8_t encaps )
+{
+	struct dvb_net_if params;
+
+	memset ( &params, 0, sizeof(params) );
+	params.pid = pid;
+	params.feedtype = ( encaps ) ? DVB_NET_FEEDTYPE_ULE : DVB_NET_FEEDTYPE_MPE;
+
+	int ret = ioctl ( net_fd, NET_ADD_IF, &params );
+
+	if ( ret == -1 ) return ret;
+
+	return params.if_num;
+}
+
+static DvbnetIf * dvbnet_if_find ( uint8_t adapter, uint8_t net, uint8_t if_num, Dvbnet *dvbnet )
+{
+	GList *list = NULL; for ( list = dvbnet->ifs; list != NULL; list = list->next )
+	{
+		DvbnetIf *rec = (DvbnetIf *)list->data;
+
+		if ( rec->adapter == adapter && rec->net == net && rec->if_num == if_num ) return rec;
+	}
+
+	return NULL;
+}
+
+static void dvbnet_if_free ( DvbnetIf *rec )
+{
+	g_free ( rec->ip  );
+	g_free ( rec->mac );
+	g_list_free_full ( rec->mcast, g_free );
+	g_free ( rec );
+}
+
+static DvbnetIf * dvbnet_if_track_add ( uint8_t adapter, uint8_t net, uint8_t if_num, uint16_t pid, uint8_t encaps, Dvbnet *dvbnet )
+{
+	DvbnetIf *rec = dvbnet_if_find ( adapter, net, if_num, dvbnet );
+
+	if ( rec == NULL )
+	{
+		rec = g_new0 ( DvbnetIf, 1 );
+		dvbnet->ifs = g_list_append ( dvbnet->ifs, rec );
+	}
+
+	rec->adapter = adapter;
+	rec->net     = net;
+	rec->if_num  = if_num;
+	rec->pid     = pid;
+	rec->encaps  = encaps;
+
+	return rec;
+}
+
+static void dvbnet_if_track_str ( uint8_t adapter, uint8_t net, uint8_t if_num, const char *ip, const char *mac, Dvbnet *dvbnet )
+{
+	DvbnetIf *rec = dvbnet_if_find ( adapter, net, if_num, dvbnet );
+
+	if ( rec == NULL ) return;
+
+	if ( ip  ) { g_free ( rec->ip  ); rec->ip  = g_strdup ( ip  ); }
+	if ( mac ) { g_free ( rec->mac ); rec->mac = g_strdup ( mac ); }
+}
+
+static void dvbnet_if_track_rx ( uint8_t adapter, uint8_t net, uint8_t if_num, uint8_t rx_mode, Dvbnet *dvbnet )
+{
+	DvbnetIf *rec = dvbnet_if_find ( adapter, net, if_num, dvbnet );
+
+	if ( rec ) rec->rx_mode = rx_mode;
+}
+
+static void dvbnet_if_track_mcast ( uint8_t adapter, uint8_t net, uint8_t if_num, const char *mac, gboolean add, Dvbnet *dvbnet )
+{
+	DvbnetIf *rec = dvbnet_if_find ( adapter, net, if_num, dvbnet );
+
+	if ( rec == NULL ) return;
+
+	GList *found = g_list_find_custom ( rec->mcast, mac, (GCompareFunc)g_strcmp0 );
+
+	if ( add && !found ) rec->mcast = g_list_append ( rec->mcast, g_strdup ( mac ) );
+
+	if ( !add && found ) { g_free ( found->data ); rec->mcast = g_list_delete_link ( rec->mcast, found ); }
+}
+
+static void dvbnet_if_track_del ( uint8_t adapter, uint8_t net, uint8_t if_num, Dvbnet *dvbnet )
+{
+	DvbnetIf *rec = dvbnet_if_find ( adapter, net, if_num, dvbnet );
+
+	if ( rec == NULL ) return;
+
+	dvbnet->ifs = g_list_remove ( dvbnet->ifs, rec );
+	dvbnet_if_free ( rec );
+}
+
+/* Re-reads the records of a net device whose node is still the one it was restored on; interfaces gone from it were removed */
+static void dvbnet_supervisor_refresh_dev ( uint8_t adapter, uint8_t net, uint64_t ino, Dvbnet *dvbnet )
+{
+	int net_fd = dvbnet_open_dev ( adapter, net );
+
+	if ( net_fd == -1 ) return;
+
+	struct stat st;
+
+	/* A new node: the adapter was reset, the restore is up to the monitor */
+	if ( fstat ( net_fd, &st ) == -1 || (uint64_t)st.st_ino != ino ) { close ( net_fd ); return; }
+
+	gboolean seen[UINT8_MAX] = {};
+	char net_name[20] = {};
+
+	uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
+	{
+		uint16_t pid = 0;
+		uint8_t encaps = 0;
+
+		if ( dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps ) == -1 )
+		{
+			/* EINVAL: free slot, anything else: the device is going away */
+			if ( errno != EINVAL ) { close ( net_fd ); return; }
+
+			continue;
+		}
+
+		seen[ifs] = TRUE;
+		dvbnet_if_name ( net_name, adapter, net, ifs );
+
+		DvbnetIf *rec = dvbnet_if_track_add ( adapter, net, ifs, pid, encaps, dvbnet );
+
+		g_free ( rec->ip  );
+		g_free ( rec->mac );
+		g_list_free_full ( rec->mcast, g_free );
+
+		rec->ip  = dvbnet_get_mac_ip ( net_name, 0 );
+		rec->mac = dvbnet_get_mac_ip ( net_name, 1 );
+		rec->up  = dvbnet_get_if_up ( net_name );
+
+		rec->rx_mode = dvbnet_get_rx_mode ( net_name );
+		rec->mcast   = dvbnet_get_mcast ( net_name, TRUE );
+	}
+
+	close ( net_fd );
+
+	GList *list = dvbnet->ifs; while ( list != NULL )
+	{
+		GList *next = list->next;
+		DvbnetIf *rec = (DvbnetIf *)list->data;
+
+		if ( rec->adapter == adapter && rec->net == net && !seen[rec->if_num] )
+		{
+			dvbnet->ifs = g_list_delete_link ( dvbnet->ifs, list );
+			dvbnet_if_free ( rec );
+		}
+
+		list = next;
+	}
+}
+
+/* Interfaces added or changed by other programs ( dvbnet, ip ) are picked up here */
+static gboolean dvbnet_supervisor_refresh ( Dvbnet *dvbnet )
+{
+	GHashTableIter iter;
+	gpointer key, value;
+
+	g_hash_table_iter_init ( &iter, dvbnet->lives );
+
+	while ( g_hash_table_iter_next ( &iter, &key, &value ) )
+	{
+		if ( g_hash_table_contains ( dvbnet->restores, key ) ) continue;
+
+		guint dev = GPOINTER_TO_UINT ( key );
+
+		dvbnet_supervisor_refresh_dev ( (uint8_t)( dev >> 8 ), (uint8_t)( dev & 0xFF ), *(uint64_t *)value, dvbnet );
+	}
+
+	return G_SOURCE_CONTINUE;
+}
+
+static void dvbnet_supervisor_live ( uint8_t adapter, uint8_t net, int net_fd, Dvbnet *dvbnet )
+{
+	struct stat st;
+	uint64_t *ino = g_new0 ( uint64_t, 1 );
+
+	if ( fstat ( net_fd, &st ) == 0 ) *ino = (uint64_t)st.st_ino;
+
+	g_hash_table_insert ( dvbnet->lives, GUINT_TO_POINTER ( ( adapter << 8 ) | net ), ino );
+}
+
+/* Returns FALSE while the net device can not be opened yet */
+static gboolean dvbnet_supervisor_apply ( uint8_t adapter, uint8_t net, int64_t start, Dvbnet *dvbnet )
+{
+	int net_fd = dvbnet_open_dev ( adapter, net );
+
+	if ( net_fd == -1 ) return FALSE;
+
+	dvbnet_supervisor_live ( adapter, net, net_fd, dvbnet );
+
+	uint16_t pid = 0;
+	uint8_t encaps = 0, done = 0;
+
+	/* Interfaces are only re-created on a fresh device */
+	uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
+		if ( dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps ) == 0 ) { close ( net_fd ); return TRUE; }
+
+	int last = -1;
+	DvbnetIf *slots[UINT8_MAX] = {};
+
+	GList *list = NULL; for ( list = dvbnet->ifs; list != NULL; list = list->next )
+	{
+		DvbnetIf *rec = (DvbnetIf *)list->data;
+
+		if ( rec->adapter != adapter || rec->net != net ) continue;
+
+		slots[rec->if_num] = rec;
+		last = MAX ( last, rec->if_num );
+	}
+
+	char net_name[20] = {};
+	gboolean temps[UINT8_MAX] = {};
+
+	/* The kernel takes the first free IF-Num: free slots below the last record get a placeholder, so names stay */
+	int k = 0; for ( k = 0; k <= last; k++ )
+	{
+		DvbnetIf *rec = slots[k];
+
+		int ret = ( rec ) ? dvbnet_net_add_if ( net_fd, rec->pid, rec->encaps ) : -1;
+
+		if ( rec && ret == -1 )
+		{
+			g_warning ( "Adapter %u net %u IF-Num %d ( pid 0x%.4X ): not restored, %s", adapter, net, k, rec->pid, g_strerror ( errno ) );
+
+			dvbnet->ifs = g_list_remove ( dvbnet->ifs, rec );
+			dvbnet_if_free ( rec );
+
+			rec = NULL;
+		}
+
+		if ( rec == NULL )
+		{
+			/* Pid 0x1FFF: null packets, nothing is received */
+			ret = dvbnet_net_add_if ( net_fd, 0x1FFF, 0 );
+
+			if ( ret == -1 ) { g_warning ( "Adapter %u net %u IF-Num %d: placeholder failed, %s", adapter, net, k, g_strerror ( errno ) ); continue; }
+
+			temps[ret] = TRUE;
+			continue;
+		}
+
+		if ( ret != k ) g_warning ( "Adapter %u net %u: IF-Num %d re-created as %d", adapter, net, k, ret );
+
+		rec->if_num = (uint8_t)ret;
+		dvbnet_if_name ( net_name, adapter, net, rec->if_num );
+
+		if ( rec->mac ) dvbnet_set_mac ( net_name, rec->mac );
+		if ( rec->ip  ) dvbnet_set_ip  ( net_name, rec->ip  );
+
+		if ( rec->rx_mode != RX_FILTER ) dvbnet_set_rx_mode ( net_name, rec->rx_mode );
+
+		GList *mcast = NULL; for ( mcast = rec->mcast; mcast != NULL; mcast = mcast->next )
+			dvbnet_set_mcast ( net_name, (char *)mcast->data, TRUE );
+
+		if ( rec->up || rec->ip ) dvbnet_set_if_up ( net_name, TRUE );
+
+		done++;
+	}
+
+	for ( k = 0; k <= last; k++ )
+		if ( temps[k] && ioctl ( net_fd, NET_REMOVE_IF, k ) == -1 ) perror ( "NET_REMOVE_IF" );
+
+	close ( net_fd );
+
+	if ( !done ) return TRUE;
+
+	g_message ( "Adapter %u net %u: %u interfaces restored in %.1f ms", adapter, net, done, (double)( g_get_monotonic_time () - start ) / 1000 );
+
+	if ( dvbnet->window && adapter == dvbnet->dvb_adapter && net == dvbnet->dvb_net ) dvbnet_set_if_info ( dvbnet );
+
+	return TRUE;
+}
+
+static gboolean dvbnet_supervisor_retry ( DvbnetRestore *rs )
+{
+	if ( !dvbnet_supervisor_apply ( rs->adapter, rs->net, rs->start, rs->dvbnet ) && ++rs->tries < 250 ) return G_SOURCE_CONTINUE;
+
+	if ( rs->tries >= 250 ) g_warning ( "Adapter %u net %u: open net device failed", rs->adapter, rs->net );
+
+	rs->src_id = 0;
+	g_hash_table_remove ( rs->dvbnet->restores, GUINT_TO_POINTER ( ( rs->adapter << 8 ) | rs->net ) );
+
+	return G_SOURCE_REMOVE;
+}
+
+static void dvbnet_supervisor_cancel ( DvbnetRestore *rs )
+{
+	if ( rs->src_id ) g_source_remove ( rs->src_id );
+
+	g_free ( rs );
+}
+
+static void dvbnet_supervisor_schedule ( uint8_t adapter, uint8_t net, Dvbnet *dvbnet )
+{
+	gpointer key = GUINT_TO_POINTER ( ( adapter << 8 ) | net );
+
+	if ( g_hash_table_contains ( dvbnet->restores, key ) ) return;
+
+	int64_t start = g_get_monotonic_time ();
+
+	if ( dvbnet_supervisor_apply ( adapter, net, start, dvbnet ) ) return;
+
+	/* The node exists before udev has set it up: poll briefly until it opens */
+	DvbnetRestore *rs = g_new0 ( DvbnetRestore, 1 );
+
+	rs->dvbnet  = dvbnet;
+	rs->adapter = adapter;
+	rs->net     = net;
+	rs->start   = start;
+	rs->src_id  = g_timeout_add ( 20, (GSourceFunc)dvbnet_supervisor_retry, rs );
+
+	g_hash_table_insert ( dvbnet->restores, key, rs );
+}
+
+static void dvbnet_supervisor_scan ( const char *path, Dvbnet *dvbnet );
+
+static void dvbnet_supervisor_changed ( G_GNUC_UNUSED GFileMonitor *monitor, GFile *file, G_GNUC_UNUSED GFile *other, GFileMonitorEvent event, Dvbnet *dvbnet )
+{
+	if ( event != G_FILE_MONITOR_EVENT_CREATED && event != G_FILE_MONITOR_EVENT_DELETED ) return;
+
+	char *path = g_file_get_path ( file );
+
+	if ( path == NULL ) return;
+
+	char c = 0;
+	unsigned int adapter = 0, net = 0;
+
+	if ( event == G_FILE_MONITOR_EVENT_CREATED )
+		dvbnet_supervisor_scan ( path, dvbnet );
+	else if ( sscanf ( path, "/dev/dvb/adapter%u/net%u%c", &adapter, &net, &c ) == 2 )
+		g_hash_table_remove ( dvbnet->lives, GUINT_TO_POINTER ( ( adapter << 8 ) | net ) );
+	else
+		g_hash_table_remove ( dvbnet->monitors, path );
+
+	g_free ( path );
+}
+
+static void dvbnet_supervisor_unwatch ( GFileMonitor *monitor )
+{
+	g_file_monitor_cancel ( monitor );
+	g_object_unref ( monitor );
+}
+
+static void dvbnet_supervisor_watch ( const char *path, Dvbnet *dvbnet )
+{
+	if ( g_hash_table_contains ( dvbnet->monitors, path ) ) return;
+
+	GFile *file = g_file_new_for_path ( path );
+	GFileMonitor *monitor = g_file_monitor_directory ( file, G_FILE_MONITOR_NONE, NULL, NULL );
+	g_object_unref ( file );
+
+	if ( monitor == NULL ) return;
+
+	g_signal_connect ( monitor, "changed", G_CALLBACK ( dvbnet_supervisor_changed ), dvbnet );
+
+	g_hash_table_insert ( dvbnet->monitors, g_strdup ( path ), monitor );
+}
+
+static void dvbnet_supervisor_scan ( const char *path, Dvbnet *dvbnet )
+{
+	char c = 0;
+	unsigned int adapter = 0, net = 0;
+
+	if ( sscanf ( path, "/dev/dvb/adapter%u/net%u%c", &adapter, &net, &c ) == 2 )
+	{
+		if ( adapter <= UINT8_MAX && net <= UINT8_MAX ) dvbnet_supervisor_schedule ( (uint8_t)adapter, (uint8_t)net, dvbnet );
+
+		return;
+	}
+
+	if ( !g_str_equal ( path, "/dev/dvb" ) && sscanf ( path, "/dev/dvb/adapter%u%c", &adapter, &c ) != 1 ) return;
+
+	if ( !g_file_test ( path, G_FILE_TEST_IS_DIR ) ) return;
+
+	/* Watch first, then list: nodes created in between are not missed */
+	dvbnet_supervisor_watch ( path, dvbnet );
+
+	GDir *dir = g_dir_open ( path, 0, NULL );
+
+	if ( dir == NULL ) return;
+
+	const char *name = NULL; while ( ( name = g_dir_read_name ( dir ) ) )
+	{
+		char *child = g_build_filename ( path, name, NULL );
+
+		dvbnet_supervisor_scan ( child, dvbnet );
+
+		g_free ( child );
+	}
+
+	g_dir_close ( dir );
+}
+
+static void dvbnet_supervisor_stop ( Dvbnet *dvbnet )
+{
+	if ( dvbnet->refresh_id ) g_source_remove ( dvbnet->refresh_id );
+
+	if ( dvbnet->monitors ) g_hash_table_destroy ( dvbnet->monitors );
+	if ( dvbnet->restores ) g_hash_table_destroy ( dvbnet->restores );
+	if ( dvbnet->lives    ) g_hash_table_destroy ( dvbnet->lives    );
+
+	dvbnet->refresh_id = 0;
+	dvbnet->monitors = NULL;
+	dvbnet->restores = NULL;
+	dvbnet->lives    = NULL;
+}
+
+static void dvbnet_supervisor_start ( Dvbnet *dvbnet )
+{
+	dvbnet_supervisor_stop ( dvbnet );
+
+	g_list_free_full ( dvbnet->ifs, (GDestroyNotify)dvbnet_if_free );
+	dvbnet->ifs = NULL;
+
+	dvbnet->lives    = g_hash_table_new_full ( g_direct_hash, g_direct_equal, NULL, g_free );
+	dvbnet->monitors = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, (GDestroyNotify)dvbnet_supervisor_unwatch );
+	dvbnet->restores = g_hash_table_new_full ( g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)dvbnet_supervisor_cancel );
+
+	/* /dev/dvb itself goes away with the last adapter */
+	dvbnet_supervisor_watch ( "/dev", dvbnet );
+	dvbnet_supervisor_scan  ( "/dev/dvb", dvbnet );
+
+	/* Records start from the interfaces there are now */
+	dvbnet_supervisor_refresh ( dvbnet );
+
+	dvbnet->refresh_id = g_timeout_add_seconds ( 1, (GSourceFunc)dvbnet_supervisor_refresh, dvbnet );
+}
+
+static void dvbnet_del_if ( int net_fd, Dvbnet *dvbnet )
+{
+	char net_name[20] = {};
+	dvbnet_if_name ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num );
+
+	dvbnet_set_if_up ( net_name, FALSE );
+
+	sleep  ( 1 );
+
+	int ret = ioctl ( net_fd, NET_REMOVE_IF, dvbnet->if_num );
+
+	if ( ret == -1 )
+	{
+		perror ( "NET_REMOVE_IF" );
+		dvbnet_message_dialog ( "NET_REMOVE_IF", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
+	}
+	else
+		dvbnet_if_track_del ( dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num, dvbnet );
+}
+
+static int dvbnet_add_if ( int net_fd, Dvbnet *dvbnet )
+{
+	int ret = dvbnet_net_add_if ( net_fd, dvbnet->net_pid, dvbnet->net_ens );
+
+	if ( ret == -1 )
+	{
+		perror ( "NET_ADD_IF" );
+		dvbnet_message_dialog ( "NET_ADD_IF", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
+	}
+	else
+		dvbnet_if_track_add ( dvbnet->dvb_adapter, dvbnet->dvb_net, (uint8_t)ret, dvbnet->net_pid, dvbnet->net_ens, dvbnet );
+
+	return ret;
+}
+
+static void dvbnet_add ( Dvbnet *dvbnet )
+{
+	int net_fd = dvbnet_open ( dvbnet );
+
+	if ( net_fd == -1 ) return;
+
+	dvbnet_add_if ( net_fd, dvbnet );
+
+	close ( net_fd );
+}
+
+static gboolean dvbnet_get_fe_lock ( uint8_t adapter )
+{
+	char file[80] = {};
+	sprintf ( file, "/dev/dvb/adapter%u/frontend0", adapter );
+
+	int fd = open ( file, O_RDONLY | O_NONBLOCK );
+
+	if ( fd == -1 ) return FALSE;
+
+	fe_status_t status = 0;
+
+	int ret = ioctl ( fd, FE_READ_STATUS, &status );
+
+	close ( fd );
+
+	return ( ret == 0 && ( status & FE_HAS_LOCK ) );
+}
+
+/* Received bytes of all interfaces on the net device, NULL count is allowed */
+static uint64_t dvbnet_get_net_load ( int net_fd, uint8_t adapter, uint8_t net, uint8_t *count )
+{
+	char net_name[20] = {};
+	uint64_t bytes = 0;
+
+	uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
+	{
+		uint16_t pid = 0;
+		uint8_t encaps = 0;
+
+		if ( dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps ) == -1 ) continue;
+
+		dvbnet_if_name ( net_name, adapter, net, ifs );
+
+		bytes += dvbnet_get_stat ( net_name, "rx_bytes" );
+
+		if ( count ) *count += 1;
+	}
+
+	return bytes;
+}
+
+/*
+ * Placement of a new interface with this pid is measured over a short interval:
+ * the mux first ( pid seen on the demux, else tuner locked ),
+ * then the lowest receive rate, then the fewest interfaces.
+ * Net devices without a free interface are skipped, without a locked tuner there is no placement.
+ */
+static gboolean dvbnet_place_begin ( uint16_t pid, DvbnetPlace *place )
+{
+	place->pid = pid;
+	place->n   = 0;
+
+	uint8_t adapter = 0; for ( adapter = 0; adapter <= DVBNET_DEV_MAX; adapter++ )
+	{
+		gboolean lock = dvbnet_get_fe_lock ( adapter );
+
+		uint8_t net = 0; for ( net = 0; net <= DVBNET_DEV_MAX; net++ )
+		{
+			int net_fd = dvbnet_open_dev ( adapter, net );
+
+			if ( net_fd == -1 ) continue;
+
+			uint8_t count = 0;
+			uint64_t bytes = dvbnet_get_net_load ( net_fd, adapter, net, &count );
+
+			close ( net_fd );
+
+			if ( count >= DVB_NET_DEVICES_MAX ) continue;
+
+			struct _DvbnetPlaceDev *dev = &place->dev[place->n++];
+
+			dev->adapter = adapter;
+			dev->net     = net;
+			dev->count   = count;
+			dev->mux     = ( lock ) ? PLACE_LOCK : PLACE_NO_LOCK;
+			dev->bytes   = bytes;
+
+			/* Net device N receives from demux N */
+			dev->demux_fd = ( lock ) ? dvbnet_probe_pid ( adapter, net, pid, 0 ) : -1;
+		}
+	}
+
+	return ( place->n > 0 );
+}
+
+/* Returns the mux match of the chosen net device, PLACE_NONE when no candidate is left */
+static uint8_t dvbnet_place_end ( DvbnetPlace *place, uint8_t *adapter_ret, uint8_t *net_ret )
+{
+	int best = -1;
+
+	uint16_t i = 0; for ( i = 0; i < place->n; i++ )
+	{
+		struct _DvbnetPlaceDev *dev = &place->dev[i];
+
+		int net_fd = dvbnet_open_dev ( dev->adapter, dev->net );
+
+		/* Not measured, nor could the interface be added */
+		if ( net_fd == -1 ) continue;
+
+		uint8_t count = 0;
+		uint64_t bytes = dvbnet_get_net_load ( net_fd, dev->adapter, dev->net, &count );
+
+		close ( net_fd );
+
+		if ( count >= DVB_NET_DEVICES_MAX ) continue;
+
+		dev->count = count;
+		dev->bytes = ( bytes > dev->bytes ) ? bytes - dev->bytes : 0;
+
+		if ( dvbnet_probe_seen ( dev->demux_fd ) ) dev->mux = PLACE_PID;
+
+		if ( best == -1 ) { best = i; continue; }
+
+		struct _DvbnetPlaceDev *b = &place->dev[best];
+
+		if ( dev->mux != b->mux ) { if ( dev->mux > b->mux ) best = i; continue; }
+		if ( dev->bytes != b->bytes ) { if ( dev->bytes < b->bytes ) best = i; continue; }
+		if ( dev->count < b->count ) best = i;
+	}
+
+	if ( best == -1 ) return PLACE_NONE;
+
+	*adapter_ret = place->dev[best].adapter;
+	*net_ret     = place->dev[best].net;
+
+	return place->dev[best].mux;
+}
+
+static const char * dvbnet_place_info ( uint8_t result )
+{
+	const char *info[] = { "No net device with a free interface", "No tuner has lock", "Tuner lock, pid not seen", "Pid seen" };
+
+	return info[result];
+}
+
+static void dvbnet_place_free ( DvbnetPlace *place )
+{
+	uint16_t i = 0; for ( i = 0; i < place->n; i++ )
+		if ( place->dev[i].demux_fd != -1 ) close ( place->dev[i].demux_fd );
+
+	g_free ( place );
+}
+
+static uint8_t dvbnet_place ( uint16_t pid, uint8_t *adapter_ret, uint8_t *net_ret )
+{
+	DvbnetPlace *place = g_new0 ( DvbnetPlace, 1 );
+
+	uint8_t ret = PLACE_NONE;
+
+	if ( dvbnet_place_begin ( pid, place ) )
+	{
+		g_usleep ( DVBNET_PLACE_MS * 1000 );
+		ret = dvbnet_place_end ( place, adapter_ret, net_ret );
+	}
+
+	dvbnet_place_free ( place );
+
+	return ret;
+}
+
+static gboolean dvbnet_place_timeout ( Dvbnet *dvbnet )
+{
+	uint8_t adapter = 0, net = 0;
+
+	uint8_t ret = dvbnet_place_end ( dvbnet->place, &adapter, &net );
+	dvbnet_place_free ( dvbnet->place );
+
+	dvbnet->place = NULL;
+	dvbnet->place_id = 0;
+
+	if ( ret < PLACE_LOCK )
+	{
+		gtk_label_set_text ( dvbnet->label_place, "" );
+		dvbnet_message_dialog ( "Auto placement", dvbnet_place_info ( ret ), GTK_MESSAGE_ERROR, dvbnet->window );
+
+		return G_SOURCE_REMOVE;
+	}
+
+	char *text = g_strdup_printf ( "Adapter %u Net %u: %s", adapter, net, dvbnet_place_info ( ret ) );
+	gtk_label_set_text ( dvbnet->label_place, text );
+	g_free ( text );
+
+	dvbnet->dvb_adapter = adapter;
+	dvbnet->dvb_net = net;
+
+	gtk_spin_button_set_value ( dvbnet->spin_adapter, adapter );
+	gtk_spin_button_set_value ( dvbnet->spin_net, net );
+
+	dvbnet_add ( dvbnet );
+	dvbnet_set_if_info ( dvbnet );
+
+	return G_SOURCE_REMOVE;
 }
 
-static int dvbnet_get_if_info ( int fd, uint8_t ifnum, uint16_t *pid, uint8_t *encaps )
+/* Measures without blocking the window, then adds the interface */
+static void dvbnet_place_add ( Dvbnet *dvbnet )
 {
-	struct dvb_net_if info;
+	if ( dvbnet->place ) return;
 
-	memset ( &info, 0, sizeof(struct dvb_net_if) );
-	info.if_num = ifnum;
-
-	int ret = ioctl ( fd, NET_GET_IF, &info );
+	dvbnet->place = g_new0 ( DvbnetPlace, 1 );
 
-	if ( ret == -1 ) return ret;
+	if ( !dvbnet_place_begin ( dvbnet->net_pid, dvbnet->place ) )
+	{
+		dvbnet_place_free ( dvbnet->place );
+		dvbnet->place = NULL;
 
-	*pid = info.pid;
-	*encaps = info.feedtype;
+		dvbnet_message_dialog ( "Auto placement", dvbnet_place_info ( PLACE_NONE ), GTK_MESSAGE_ERROR, dvbnet->window );
+		return;
+	}
 
-	return 0;
+	dvbnet->place_id = g_timeout_add ( DVBNET_PLACE_MS, (GSourceFunc)dvbnet_place_timeout, dvbnet );
 }
 
-static char * dvbnet_get_mac_ip ( const char *net_name, uint8_t mac_ip )
+/* PID[:mpe|ule] per item, placed automatically */
+static int dvbnet_batch_add ( char **adds, Dvbnet *dvbnet )
 {
-	struct ifreq ifr;
+	int status = 0;
 
-	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+	guint i = 0; for ( i = 0; adds[i] != NULL; i++ )
+	{
+		char *end = NULL;
+		char **spec = g_strsplit ( adds[i], ":", 2 );
 
-	if ( fd < 0 ) { perror ( "socket" ); return NULL; }
+		unsigned long pid = 0;
+		uint8_t encaps = 0;
+		gboolean valid = FALSE;
 
-	memset ( &ifr, 0x00, sizeof(ifr) );
-	strcpy ( ifr.ifr_name, net_name  );
+		if ( spec[0] != NULL && *spec[0] != '\0' )
+		{
+			pid = strtoul ( spec[0], &end, 0 );
+			encaps = ( spec[1] && g_ascii_strcasecmp ( spec[1], "ule" ) == 0 );
 
-	if ( mac_ip )
-	{
-		if ( ioctl ( fd, SIOCGIFHWADDR, &ifr ) < 0 ) { close ( fd ); return NULL; }
+			valid = ( *end == '\0' && pid <= 0x1FFF && ( !spec[1] || encaps || g_ascii_strcasecmp ( spec[1], "mpe" ) == 0 ) );
+		}
 
-		char *ret = malloc ( 18 );
+		g_strfreev ( spec );
 
-		uint8_t i = 0; for ( i = 0; i < 6; ++i )
-			snprintf ( ret + (i*3), (size_t)(18 - (i*3)), "%02x%s", (uint8_t)ifr.ifr_addr.sa_data[i], ":" );
+		if ( !valid ) { g_printerr ( "%s: invalid PID[:mpe|ule]\n", adds[i] ); status = 1; continue; }
 
-		close ( fd );
+		uint8_t adapter = 0, net = 0;
+		uint8_t place = dvbnet_place ( (uint16_t)pid, &adapter, &net );
 
-		return ret;
-	}
-	else
-	{
-		if ( ioctl ( fd, SIOCGIFADDR, &ifr ) < 0 ) { close ( fd ); return NULL; }
+		if ( place < PLACE_LOCK ) { g_printerr ( "%s: %s\n", adds[i], dvbnet_place_info ( place ) ); status = 1; continue; }
 
-		char *ret = g_strdup ( inet_ntoa ( ( (struct sockaddr_in *)&ifr.ifr_addr )->sin_addr ) );
+		int net_fd = dvbnet_open_dev ( adapter, net );
 
-		close ( fd );
+		int ret = ( net_fd == -1 ) ? -1 : dvbnet_net_add_if ( net_fd, (uint16_t)pid, encaps );
 
-		return ret;
+		if ( ret == -1 )
+		{
+			g_printerr ( "%s: adapter %u net %u: %s\n", adds[i], adapter, net, g_strerror ( errno ) );
+			status = 1;
+		}
+		else
+		{
+			char net_name[20] = {};
+			dvbnet_if_name ( net_name, adapter, net, (uint8_t)ret );
+
+			dvbnet_if_track_add ( adapter, net, (uint8_t)ret, (uint16_t)pid, encaps, dvbnet );
+			g_print ( "%s: adapter %u net %u pid 0x%.4lX %s ( %s )\n", net_name, adapter, net, pid, ( encaps ) ? "Ule" : "Mpe", dvbnet_place_info ( place ) );
+		}
+
+		if ( net_fd != -1 ) close ( net_fd );
 	}
 
-	return NULL;
+	return status;
 }
 
-static void dvbnet_set_mac ( const char *net_name, const char *mac )
+/* Finds adapter, net device and IF-Num of an existing interface */
+static gboolean dvbnet_if_lookup ( const char *name, uint8_t *adapter_ret, uint8_t *net_ret, uint8_t *if_num_ret )
 {
-	struct ifreq ifr;
+	char net_name[20] = {};
 
-	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+	uint8_t adapter = 0; for ( adapter = 0; adapter <= DVBNET_DEV_MAX; adapter++ )
+	{
+		uint8_t net = 0; for ( net = 0; net <= DVBNET_DEV_MAX; net++ )
+		{
+			int net_fd = dvbnet_open_dev ( adapter, net );
 
-	if ( fd < 0 ) { perror ( "socket" ); return; }
+			if ( net_fd == -1 ) continue;
 
-	sscanf ( mac, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
-		&ifr.ifr_hwaddr.sa_data[0],
-		&ifr.ifr_hwaddr.sa_data[1],
-		&ifr.ifr_hwaddr.sa_data[2],
-		&ifr.ifr_hwaddr.sa_data[3],
-		&ifr.ifr_hwaddr.sa_data[4],
-		&ifr.ifr_hwaddr.sa_data[5] );
+			uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
+			{
+				uint16_t pid = 0;
+				uint8_t encaps = 0;
 
-	strcpy ( ifr.ifr_name, net_name );
+				if ( dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps ) == -1 ) continue;
 
-	ifr.ifr_hwaddr.sa_family = ARPHRD_ETHER;
+				dvbnet_if_name ( net_name, adapter, net, ifs );
 
-	if ( ioctl ( fd, SIOCSIFHWADDR, &ifr ) < 0 ) perror ( "SIOCSIFHWADDR" );
+				if ( !g_str_equal ( net_name, name ) ) continue;
 
-	close ( fd );
-}
+				close ( net_fd );
 
-static void dvbnet_set_ip ( const char *net_name, const char *host )
-{
-	struct ifreq ifr;
-	struct sockaddr_in inet_addr;
+				*adapter_ret = adapter;
+				*net_ret     = net;
+				*if_num_ret  = ifs;
 
-	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+				return TRUE;
+			}
 
-	if ( fd < 0 ) { perror ( "socket" ); return; }
+			close ( net_fd );
+		}
+	}
 
-	bzero  ( ifr.ifr_name, IFNAMSIZ );
-	strcpy ( ifr.ifr_name, net_name );
+	return FALSE;
+}
 
-	inet_addr.sin_family = AF_INET;
-	inet_pton ( AF_INET, host, &(inet_addr.sin_addr) );
+/* IFNAME:ARG, returns ARG */
+static const char * dvbnet_batch_split ( const char *item, char net_name[20], uint8_t *adapter, uint8_t *net, uint8_t *if_num )
+{
+	const char *arg = strchr ( item, ':' );
 
-	memcpy ( &(ifr.ifr_addr), &inet_addr, sizeof (struct sockaddr) );
+	if ( arg == NULL || arg - item >= 20 ) return NULL;
 
-	if ( ioctl ( fd, SIOCSIFADDR, &ifr ) < 0 ) perror ( "SIOCSIFADDR" );
+	memcpy ( net_name, item, (size_t)( arg - item ) );
+	net_name[arg - item] = '\0';
 
-	close ( fd );
+	if ( !dvbnet_if_lookup ( net_name, adapter, net, if_num ) ) return NULL;
+
+	return arg + 1;
 }
 
-static void dvbnet_treeview_append ( const char *name, uint8_t if_num, uint16_t pid, uint8_t encaps, const char *ip_str, const char *str_mac, Dvbnet *dvbnet )
+/* IFNAME:filter|allmulti|promisc per item */
+static int dvbnet_batch_rx ( char **items, Dvbnet *dvbnet )
 {
-	GtkTreeIter iter;
-	GtkTreeModel *model = gtk_tree_view_get_model ( dvbnet->treeview );
+	const char *modes[] = { "filter", "allmulti", "promisc" };
 
-	int ind = gtk_tree_model_iter_n_children ( model, NULL );
-	if ( ind >= UINT8_MAX ) return;
+	int status = 0;
 
-	char buf[20] = {};
-	sprintf ( buf, "0x%.4X", pid );
+	guint i = 0; for ( i = 0; items[i] != NULL; i++ )
+	{
+		char net_name[20] = {};
+		uint8_t adapter = 0, net = 0, if_num = 0, rx_mode = 0;
 
-	gtk_list_store_append ( GTK_LIST_STORE ( model ), &iter );
-	gtk_list_store_set    ( GTK_LIST_STORE ( model ), &iter,
-				COL_NUM, if_num,
-				COL_NAME, name,
-				COL_PID,  buf,
-				COL_ECPS, ( encaps ) ? "Ule" : "Mpe",
-				COL_STR_IP, ip_str,
-				COL_STR_MAC, str_mac,
-				-1 );
-}
+		const char *arg = dvbnet_batch_split ( items[i], net_name, &adapter, &net, &if_num );
 
-static void dvbnet_set_if_info ( Dvbnet *dvbnet )
-{
-	int net_fd = dvbnet_open ( dvbnet );
+		for ( rx_mode = 0; arg && rx_mode < G_N_ELEMENTS ( modes ); rx_mode++ )
+			if ( g_ascii_strcasecmp ( arg, modes[rx_mode] ) == 0 ) break;
 
-	if ( net_fd == -1 ) return;
+		if ( arg == NULL || rx_mode == G_N_ELEMENTS ( modes ) ) { g_printerr ( "%s: unknown interface or invalid IFNAME:filter|allmulti|promisc\n", items[i] ); status = 1; continue; }
 
-	char net_name[20] = {};
+		if ( !dvbnet_set_rx_mode ( net_name, rx_mode ) ) { g_printerr ( "%s: rx mode %s: %s\n", net_name, modes[rx_mode], g_strerror ( errno ) ); status = 1; continue; }
 
-	gtk_list_store_clear ( GTK_LIST_STORE ( gtk_tree_view_get_model ( dvbnet->treeview ) ) );
+		if ( dvbnet_get_rx_mode ( net_name ) != rx_mode ) { g_printerr ( "%s: rx mode %s not applied\n", net_name, modes[rx_mode] ); status = 1; continue; }
 
-	uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
-	{
-		uint16_t pid = 0;
-		uint8_t encaps = 0;
+		dvbnet_if_track_rx ( adapter, net, if_num, rx_mode, dvbnet );
+	}
 
-		int ret = dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps );
+	return status;
+}
 
-		if ( ret == -1 ) continue;
+/* IFNAME:GROUP|MAC per item */
+static int dvbnet_batch_mcast ( char **items, gboolean add, Dvbnet *dvbnet )
+{
+	int status = 0;
 
-		sprintf ( net_name, "dvb%u_%u", dvbnet->dvb_adapter, ifs );
+	guint i = 0; for ( i = 0; items[i] != NULL; i++ )
+	{
+		char mac[18] = {}, net_name[20] = {};
+		uint8_t adapter = 0, net = 0, if_num = 0;
 
-		char *str_ip  = dvbnet_get_mac_ip ( net_name, 0 );
-		char *str_mac = dvbnet_get_mac_ip ( net_name, 1 );
+		const char *arg = dvbnet_batch_split ( items[i], net_name, &adapter, &net, &if_num );
 
-		dvbnet_treeview_append ( net_name, ifs, pid, encaps, ( str_ip ) ? str_ip : "None", ( str_mac ) ? str_mac : "None", dvbnet );
+		if ( arg == NULL || !dvbnet_mcast_parse ( arg, mac ) ) { g_printerr ( "%s: unknown interface or invalid IFNAME:GROUP|MAC\n", items[i] ); status = 1; continue; }
 
-		free ( str_ip  );
-		free ( str_mac );
+		if ( !dvbnet_set_mcast ( net_name, mac, add ) ) { g_printerr ( "%s: %s %s: %s\n", net_name, ( add ) ? "add" : "remove", mac, g_strerror ( errno ) ); status = 1; continue; }
+
+		dvbnet_if_track_mcast ( adapter, net, if_num, mac, add, dvbnet );
 	}
 
-	close ( net_fd );
+	return status;
 }
 
-static void dvbnet_del_if ( int net_fd, Dvbnet *dvbnet )
+/* All interfaces are measured at once */
+static int dvbnet_batch_list ( void )
 {
 	char net_name[20] = {};
-	sprintf ( net_name, "dvb%u_%u", dvbnet->dvb_adapter, dvbnet->if_num );
+	GList *meters = NULL, *lines = NULL;
 
-	struct ifreq ifr;
+	uint8_t adapter = 0; for ( adapter = 0; adapter <= DVBNET_DEV_MAX; adapter++ )
+	{
+		uint8_t net = 0; for ( net = 0; net <= DVBNET_DEV_MAX; net++ )
+		{
+			int net_fd = dvbnet_open_dev ( adapter, net );
 
-	int fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+			if ( net_fd == -1 ) continue;
 
-	if ( fd < 0 ) { perror ( "socket" ); return; }
+			uint8_t ifs = 0; for ( ifs = 0; ifs < UINT8_MAX - 1; ifs++ )
+			{
+				uint16_t pid = 0;
+				uint8_t encaps = 0;
 
-	strcpy ( ifr.ifr_name, net_name );
+				if ( dvbnet_get_if_info ( net_fd, ifs, &pid, &encaps ) == -1 ) continue;
 
-	ioctl ( fd, SIOCGIFFLAGS, &ifr );
+				dvbnet_if_name ( net_name, adapter, net, ifs );
 
-	ifr.ifr_flags &= ~ IFF_UP;
-	ioctl ( fd, SIOCSIFFLAGS, &ifr );
+				char *str_mcast = NULL;
+				const char *rx_mode = dvbnet_get_rx_info ( net_name, &str_mcast );
 
-	close ( fd );
+				lines = g_list_append ( lines, g_strdup_printf ( "%s: adapter %u net %u pid 0x%.4X %s rx-mode %s mcast %s",
+					net_name, adapter, net, pid, ( encaps ) ? "Ule" : "Mpe", rx_mode, str_mcast ) );
 
-	sleep  ( 1 );
+				meters = g_list_append ( meters, dvbnet_meter_begin ( net_name, adapter, net, pid, 0 ) );
 
-	int ret = ioctl ( net_fd, NET_REMOVE_IF, dvbnet->if_num );
+				g_free ( str_mcast );
+			}
 
-	if ( ret == -1 )
-	{
-		perror ( "NET_REMOVE_IF" );
-		dvbnet_message_dialog ( "NET_REMOVE_IF", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
+			close ( net_fd );
+		}
 	}
-}
 
-static int dvbnet_add_if ( int net_fd, Dvbnet *dvbnet )
-{
-	struct dvb_net_if params;
+	GList *list = NULL, *line = NULL;
 
-	memset ( &params, 0, sizeof(params) );
-	params.pid = dvbnet->net_pid;
-	params.feedtype = ( dvbnet->net_ens ) ? DVB_NET_FEEDTYPE_ULE : DVB_NET_FEEDTYPE_MPE;
+	uint8_t t = 0; for ( t = 0; meters && t < DVBNET_METER_MS / DVBNET_METER_READ; t++ )
+	{
+		g_usleep ( DVBNET_METER_READ * 1000 );
 
-	int ret = ioctl ( net_fd, NET_ADD_IF, &params );
+		for ( list = meters; list != NULL; list = list->next ) dvbnet_meter_read ( (DvbnetMeter *)list->data );
+	}
 
-	if ( ret == -1 )
+	for ( list = meters, line = lines; list != NULL; list = list->next, line = line->next )
 	{
-		perror ( "NET_ADD_IF" );
-		dvbnet_message_dialog ( "NET_ADD_IF", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
+		char *str_rx = dvbnet_meter_end ( (DvbnetMeter *)list->data );
+
+		g_print ( "%s pid-in / accepted %s\n", (char *)line->data, str_rx );
+
+		g_free ( str_rx );
 	}
 
-	return ret;
+	g_list_free ( meters );
+	g_list_free_full ( lines, g_free );
+
+	return 0;
 }
 
-static void dvbnet_add ( Dvbnet *dvbnet )
+static void dvbnet_click_set_ip ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
 {
-	int net_fd = dvbnet_open ( dvbnet );
+	char net_name[20] = {};
+	dvbnet_if_name ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num );
 
-	if ( net_fd == -1 ) return;
+	const char *ip = gtk_entry_get_text ( dvbnet->entry_ip );
 
-	dvbnet_add_if ( net_fd, dvbnet );
+	if ( dvbnet_set_ip ( net_name, ip ) )
+		dvbnet_if_track_str ( dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num, ip, NULL, dvbnet );
+	else
+		dvbnet_message_dialog ( "SIOCSIFADDR", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
 
-	close ( net_fd );
+	dvbnet_set_if_info ( dvbnet );
 }
 
-static void dvbnet_click_set_ip ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
+static void dvbnet_click_set_mac ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
 {
 	char net_name[20] = {};
-	sprintf ( net_name, "dvb%u_%u", dvbnet->dvb_adapter, dvbnet->if_num );
+	dvbnet_if_name ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num );
+
+	const char *mac = gtk_entry_get_text ( dvbnet->entry_mac );
 
-	dvbnet_set_ip ( net_name, gtk_entry_get_text ( dvbnet->entry_ip ) );
+	if ( dvbnet_set_mac ( net_name, mac ) )
+		dvbnet_if_track_str ( dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num, NULL, mac, dvbnet );
+	else
+		dvbnet_message_dialog ( "SIOCSIFHWADDR", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
 
 	dvbnet_set_if_info ( dvbnet );
 }
 
-static void dvbnet_click_set_mac ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
+static void dvbnet_click_set_rx ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
 {
 	char net_name[20] = {};
-	sprintf ( net_name, "dvb%u_%u", dvbnet->dvb_adapter, dvbnet->if_num );
+	dvbnet_if_name ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num );
 
-	dvbnet_set_mac ( net_name, gtk_entry_get_text ( dvbnet->entry_mac ) );
+	if ( dvbnet_set_rx_mode ( net_name, dvbnet->rx_mode ) )
+		dvbnet_if_track_rx ( dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num, dvbnet->rx_mode, dvbnet );
+	else
+		dvbnet_message_dialog ( "SIOCSIFFLAGS", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
+
+	dvbnet_set_if_info ( dvbnet );
+}
+
+static void dvbnet_mcast ( gboolean add, Dvbnet *dvbnet )
+{
+	char mac[18] = {};
+
+	if ( !dvbnet_mcast_parse ( gtk_entry_get_text ( dvbnet->entry_mcast ), mac ) )
+	{
+		dvbnet_message_dialog ( gtk_entry_get_text ( dvbnet->entry_mcast ), "Not a multicast group or MAC", GTK_MESSAGE_ERROR, dvbnet->window );
+		return;
+	}
+
+	char net_name[20] = {};
+	dvbnet_if_name ( net_name, dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num );
+
+	if ( dvbnet_set_mcast ( net_name, mac, add ) )
+		dvbnet_if_track_mcast ( dvbnet->dvb_adapter, dvbnet->dvb_net, dvbnet->if_num, mac, add, dvbnet );
+	else
+		dvbnet_message_dialog ( ( add ) ? "SIOCADDMULTI" : "SIOCDELMULTI", g_strerror ( errno ), GTK_MESSAGE_ERROR, dvbnet->window );
 
 	dvbnet_set_if_info ( dvbnet );
 }
 
+static void dvbnet_click_add_mcast ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
+{
+	dvbnet_mcast ( TRUE, dvbnet );
+}
+
+static void dvbnet_click_del_mcast ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
+{
+	dvbnet_mcast ( FALSE, dvbnet );
+}
+
 static void dvbnet_click_del_if ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
 {
 	int net_fd = dvbnet_open ( dvbnet );
@@ -413,6 +1852,23 @@ static void dvbnet_act_if_num ( enum mode act, Dvbnet *dvbnet )
 		g_signal_connect ( button, "clicked", G_CALLBACK ( dvbnet_click_set_mac ), dvbnet );
 	}
 
+	if ( act == SET_RX )
+	{
+		button = (GtkButton *)gtk_button_new_with_label ( "Set Rx mode" );
+		g_signal_connect ( button, "clicked", G_CALLBACK ( dvbnet_click_set_rx ), dvbnet );
+	}
+
+	if ( act == SET_MCAST )
+	{
+		button = (GtkButton *)gtk_button_new_with_label ( "➖" );
+		g_signal_connect ( button, "clicked", G_CALLBACK ( dvbnet_click_del_mcast ), dvbnet );
+		g_signal_connect_swapped ( button, "clicked", G_CALLBACK ( gtk_widget_destroy ), window );
+		gtk_box_pack_end ( h_box, GTK_WIDGET ( button ), TRUE, TRUE, 0 );
+
+		button = (GtkButton *)gtk_button_new_with_label ( "➕" );
+		g_signal_connect ( button, "clicked", G_CALLBACK ( dvbnet_click_add_mcast ), dvbnet );
+	}
+
 	g_signal_connect_swapped ( button, "clicked", G_CALLBACK ( gtk_widget_destroy ), window );
 	gtk_box_pack_end ( h_box, GTK_WIDGET ( button ), TRUE, TRUE, 0 );
 
@@ -434,6 +1890,16 @@ static void dvbnet_clicked_button_net_mac ( G_GNUC_UNUSED GtkButton *button, Dvb
 	dvbnet_act_if_num ( SET_MAC, dvbnet );
 }
 
+static void dvbnet_clicked_button_net_rx ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
+{
+	dvbnet_act_if_num ( SET_RX, dvbnet );
+}
+
+static void dvbnet_clicked_button_net_mcast ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
+{
+	dvbnet_act_if_num ( SET_MCAST, dvbnet );
+}
+
 static void dvbnet_del ( Dvbnet *dvbnet )
 {
 	dvbnet_act_if_num ( DEL_IF, dvbnet );
@@ -441,6 +1907,8 @@ static void dvbnet_del ( Dvbnet *dvbnet )
 
 static void dvbnet_clicked_button_net_add ( G_GNUC_UNUSED GtkButton *button, Dvbnet *dvbnet )
 {
+	if ( dvbnet->net_auto ) { dvbnet_place_add ( dvbnet ); return; }
+
 	dvbnet_add ( dvbnet );
 	dvbnet_set_if_info ( dvbnet );
 }
@@ -460,6 +1928,14 @@ static void dvbnet_clicked_button_net_inf ( G_GNUC_UNUSED GtkButton *button, Dvb
 	dvbnet_about ( dvbnet );
 }
 
+static void dvbnet_toggled_button_net_svr ( GtkToggleButton *button, Dvbnet *dvbnet )
+{
+	if ( gtk_toggle_button_get_active ( button ) )
+		dvbnet_supervisor_start ( dvbnet );
+	else
+		dvbnet_supervisor_stop ( dvbnet );
+}
+
 static void dvbnet_spinbutton_changed_dvb_adapter ( GtkSpinButton *button, Dvbnet *dvbnet )
 {
 	gtk_spin_button_update ( button );
@@ -489,6 +1965,16 @@ static int dvbnet_spinbutton_hex_output ( GtkSpinButton *spinbutton, Dvbnet *dvb
 	return TRUE;
 }
 
+static void dvbnet_combo_changed_rx_mode ( GtkComboBoxText *combo_box, Dvbnet *dvbnet )
+{
+	dvbnet->rx_mode = (uint8_t)gtk_combo_box_get_active ( GTK_COMBO_BOX ( combo_box ) );
+}
+
+static void dvbnet_toggled_net_auto ( GtkToggleButton *button, Dvbnet *dvbnet )
+{
+	dvbnet->net_auto = gtk_toggle_button_get_active ( button );
+}
+
 static void dvbnet_combo_changed_dvb_ens ( GtkComboBoxText *combo_box, Dvbnet *dvbnet )
 {
 	dvbnet->net_ens = (uint8_t)gtk_combo_box_get_active ( GTK_COMBO_BOX ( combo_box ) );
@@ -515,7 +2001,7 @@ static GtkBox * dvbnet_create_net_box_props ( Dvbnet *dvbnet )
 	GtkLabel *label = (GtkLabel *)gtk_label_new ( "Adapter" );
 	gtk_widget_set_halign ( GTK_WIDGET ( label ), GTK_ALIGN_START );
 
-	GtkSpinButton *spinbutton = (GtkSpinButton *)gtk_spin_button_new_with_range ( 0, 16, 1 );
+	GtkSpinButton *spinbutton = dvbnet->spin_adapter = (GtkSpinButton *)gtk_spin_button_new_with_range ( 0, DVBNET_DEV_MAX, 1 );
 	gtk_spin_button_set_value ( spinbutton, 0 );
 	g_signal_connect ( spinbutton, "changed", G_CALLBACK ( dvbnet_spinbutton_changed_dvb_adapter ), dvbnet );
 
@@ -525,7 +2011,7 @@ static GtkBox * dvbnet_create_net_box_props ( Dvbnet *dvbnet )
 	label = (GtkLabel *)gtk_label_new ( "Net" );
 	gtk_widget_set_halign ( GTK_WIDGET ( label ), GTK_ALIGN_START );
 
-	spinbutton = (GtkSpinButton *)gtk_spin_button_new_with_range ( 0, 16, 1 );
+	spinbutton = dvbnet->spin_net = (GtkSpinButton *)gtk_spin_button_new_with_range ( 0, DVBNET_DEV_MAX, 1 );
 	gtk_spin_button_set_value ( spinbutton, 0 );
 	g_signal_connect ( spinbutton, "changed", G_CALLBACK ( dvbnet_spinbutton_changed_dvb_net ), dvbnet );
 
@@ -572,6 +2058,38 @@ static GtkBox * dvbnet_create_net_box_props ( Dvbnet *dvbnet )
 	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( button_mac ), 2, 2, 1, 1 );
 	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( dvbnet->entry_mac ), 3, 2, 1, 1 );
 
+	GtkCheckButton *check_auto = (GtkCheckButton *)gtk_check_button_new_with_label ( "Auto placement ( Adapter & Net for ➕ )" );
+	g_signal_connect ( check_auto, "toggled", G_CALLBACK ( dvbnet_toggled_net_auto ), dvbnet );
+
+	dvbnet->label_place = (GtkLabel *)gtk_label_new ( "" );
+	gtk_widget_set_halign ( GTK_WIDGET ( dvbnet->label_place ), GTK_ALIGN_START );
+
+	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( check_auto ), 0, 3, 2, 1 );
+	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( dvbnet->label_place ), 2, 3, 2, 1 );
+
+	GtkButton *button_rx = (GtkButton *)gtk_button_new_with_label ( "Rx mode" );
+	g_signal_connect ( button_rx, "clicked", G_CALLBACK ( dvbnet_clicked_button_net_rx ), dvbnet );
+
+	combo = (GtkComboBoxText *) gtk_combo_box_text_new ();
+	gtk_combo_box_text_append ( combo, "FILTER",   "Filter - unicast & mcast list" );
+	gtk_combo_box_text_append ( combo, "ALLMULTI", "All-multi" );
+	gtk_combo_box_text_append ( combo, "PROMISC",  "Promisc" );
+	gtk_combo_box_set_active ( GTK_COMBO_BOX ( combo ), 0 );
+	g_signal_connect ( combo,  "changed", G_CALLBACK ( dvbnet_combo_changed_rx_mode ), dvbnet );
+
+	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( button_rx ), 0, 4, 1, 1 );
+	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( combo ), 1, 4, 1, 1 );
+
+	GtkButton *button_mcast = (GtkButton *)gtk_button_new_with_label ( "Mcast" );
+	g_signal_connect ( button_mcast, "clicked", G_CALLBACK ( dvbnet_clicked_button_net_mcast ), dvbnet );
+
+	dvbnet->entry_mcast = (GtkEntry *)gtk_entry_new ();
+	gtk_entry_set_text ( dvbnet->entry_mcast, "239.1.1.1" );
+	gtk_widget_set_tooltip_text ( GTK_WIDGET ( dvbnet->entry_mcast ), "IPv4 group or multicast MAC" );
+
+	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( button_mcast ), 2, 4, 1, 1 );
+	gtk_grid_attach ( GTK_GRID ( grid ), GTK_WIDGET ( dvbnet->entry_mcast ), 3, 4, 1, 1 );
+
 	return v_box;
 }
 
@@ -586,7 +2104,8 @@ static GtkBox * dvbnet_create_net_box_status ( Dvbnet *dvbnet )
 	GtkScrolledWindow *scroll = (GtkScrolledWindow *)gtk_scrolled_window_new ( NULL, NULL );
 	gtk_scrolled_window_set_policy ( scroll, GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC );
 
-	GtkListStore *store = gtk_list_store_new ( NUM_COLS, G_TYPE_UINT, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING );
+	GtkListStore *store = gtk_list_store_new ( NUM_COLS, G_TYPE_UINT, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+		G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING );
 
 	dvbnet->treeview = (GtkTreeView *)gtk_tree_view_new_with_model ( GTK_TREE_MODEL ( store ) );
 
@@ -600,7 +2119,10 @@ static GtkBox * dvbnet_create_net_box_status ( Dvbnet *dvbnet )
 		{ "Pid",           "text", COL_PID  },
 		{ "Encapsulation", "text", COL_ECPS },
 		{ "Ip",            "text", COL_STR_IP  },
-		{ "Mac",           "text", COL_STR_MAC }
+		{ "Mac",           "text", COL_STR_MAC },
+		{ "Rx-Mode",       "text", COL_RX_MODE },
+		{ "Mcast",         "text", COL_STR_MCAST },
+		{ "Pid in / Accepted", "text", COL_STR_RX }
 	};
 
 	uint8_t c = 0; for ( c = 0; c < G_N_ELEMENTS ( column_n ); c++ )
@@ -636,14 +2158,19 @@ static GtkBox * dvbnet_create_net_box_control ( Dvbnet *dvbnet )
 	GtkButton *button_del = (GtkButton *)gtk_button_new_with_label ( "➖" );
 	GtkButton *button_inf = (GtkButton *)gtk_button_new_with_label ( "🛈" );
 
+	GtkToggleButton *button_svr = (GtkToggleButton *)gtk_toggle_button_new_with_label ( "👁" );
+	gtk_widget_set_tooltip_text ( GTK_WIDGET ( button_svr ), "Supervisor: recreate interfaces after adapter resets" );
+
 	g_signal_connect ( button_add, "clicked", G_CALLBACK ( dvbnet_clicked_button_net_add ), dvbnet );
 	g_signal_connect ( button_rld, "clicked", G_CALLBACK ( dvbnet_clicked_button_net_rld ), dvbnet );
 	g_signal_connect ( button_del, "clicked", G_CALLBACK ( dvbnet_clicked_button_net_del ), dvbnet );
 	g_signal_connect ( button_inf, "clicked", G_CALLBACK ( dvbnet_clicked_button_net_inf ), dvbnet );
+	g_signal_connect ( button_svr, "toggled", G_CALLBACK ( dvbnet_toggled_button_net_svr ), dvbnet );
 
 	gtk_box_pack_start ( h_box, GTK_WIDGET ( button_add ), TRUE, TRUE,  0 );
 	gtk_box_pack_start ( h_box, GTK_WIDGET ( button_rld ), TRUE, TRUE,  0 );
 	gtk_box_pack_start ( h_box, GTK_WIDGET ( button_del ), TRUE, TRUE,  0 );
+	gtk_box_pack_start ( h_box, GTK_WIDGET ( button_svr ), TRUE, TRUE,  0 );
 	gtk_box_pack_start ( h_box, GTK_WIDGET ( button_inf ), TRUE, TRUE,  0 );
 
 	gtk_box_pack_start ( v_box, GTK_WIDGET ( h_box ), FALSE, FALSE, 0 );
@@ -684,6 +2211,66 @@ static void dvbnet_activate ( GApplication *app )
 	dvbnet_new_window ( app );
 }
 
+static gboolean dvbnet_quit_loop ( GMainLoop *loop )
+{
+	g_main_loop_quit ( loop );
+
+	return G_SOURCE_CONTINUE;
+}
+
+static int dvbnet_handle_local_options ( GApplication *app, GVariantDict *options )
+{
+	Dvbnet *dvbnet = DVBNET_APPLICATION ( app );
+
+	int status = -1;
+	char **items = NULL;
+
+	if ( g_variant_dict_lookup ( options, "add", "^as", &items ) )
+	{
+		status = MAX ( status, dvbnet_batch_add ( items, dvbnet ) );
+		g_strfreev ( items );
+	}
+
+	if ( g_variant_dict_lookup ( options, "rx-mode", "^as", &items ) )
+	{
+		status = MAX ( status, dvbnet_batch_rx ( items, dvbnet ) );
+		g_strfreev ( items );
+	}
+
+	if ( g_variant_dict_lookup ( options, "mcast-del", "^as", &items ) )
+	{
+		status = MAX ( status, dvbnet_batch_mcast ( items, FALSE, dvbnet ) );
+		g_strfreev ( items );
+	}
+
+	if ( g_variant_dict_lookup ( options, "mcast-add", "^as", &items ) )
+	{
+		status = MAX ( status, dvbnet_batch_mcast ( items, TRUE, dvbnet ) );
+		g_strfreev ( items );
+	}
+
+	if ( g_variant_dict_contains ( options, "list" ) ) status = MAX ( status, dvbnet_batch_list () );
+
+	if ( !g_variant_dict_contains ( options, "supervise" ) ) return status;
+
+	dvbnet_supervisor_start ( dvbnet );
+
+	GMainLoop *loop = g_main_loop_new ( NULL, FALSE );
+
+	guint sig_int  = g_unix_signal_add ( SIGINT,  (GSourceFunc)dvbnet_quit_loop, loop );
+	guint sig_term = g_unix_signal_add ( SIGTERM, (GSourceFunc)dvbnet_quit_loop, loop );
+
+	g_main_loop_run ( loop );
+
+	g_source_remove ( sig_int  );
+	g_source_remove ( sig_term );
+	g_main_loop_unref ( loop );
+
+	dvbnet_supervisor_stop ( dvbnet );
+
+	return ( status > 0 ) ? status : 0;
+}
+
 static void dvbnet_init ( Dvbnet *dvbnet )
 {
 	dvbnet->dvb_adapter = 0;
@@ -691,16 +2278,55 @@ static void dvbnet_init ( Dvbnet *dvbnet )
 	dvbnet->net_pid = 0;
 	dvbnet->if_num  = 0;
 	dvbnet->net_ens = 0;
+	dvbnet->net_auto = FALSE;
+	dvbnet->rx_mode  = RX_FILTER;
+
+	dvbnet->ifs = NULL;
+	dvbnet->lives    = NULL;
+	dvbnet->monitors = NULL;
+	dvbnet->restores = NULL;
+	dvbnet->refresh_id = 0;
+
+	dvbnet->place = NULL;
+	dvbnet->place_id = 0;
+
+	dvbnet->meters = NULL;
+	dvbnet->meter_id = 0;
+	dvbnet->meter_ticks = 0;
+
+	static const GOptionEntry entries[] =
+	{
+		{ "add", 'a', 0, G_OPTION_ARG_STRING_ARRAY, NULL, "Add interface on the least loaded adapter & net, without window", "PID[:mpe|ule]" },
+		{ "rx-mode", 'r', 0, G_OPTION_ARG_STRING_ARRAY, NULL, "Set receive mode, without window", "IFNAME:filter|allmulti|promisc" },
+		{ "mcast-add", 'm', 0, G_OPTION_ARG_STRING_ARRAY, NULL, "Add multicast group / MAC to the filter, without window", "IFNAME:GROUP|MAC" },
+		{ "mcast-del", 'M', 0, G_OPTION_ARG_STRING_ARRAY, NULL, "Remove multicast group / MAC from the filter, without window", "IFNAME:GROUP|MAC" },
+		{ "list", 'l', 0, G_OPTION_ARG_NONE, NULL, "List interfaces with receive mode and pid input / accepted rate, without window", NULL },
+		{ "supervise", 's', 0, G_OPTION_ARG_NONE, NULL, "Recreate interfaces after adapter resets, without window", NULL },
+		{ NULL }
+	};
+
+	g_application_add_main_option_entries ( G_APPLICATION ( dvbnet ), entries );
 }
 
 static void dvbnet_finalize ( GObject *object )
 {
+	Dvbnet *dvbnet = DVBNET_APPLICATION ( object );
+
+	dvbnet_supervisor_stop ( dvbnet );
+	g_list_free_full ( dvbnet->ifs, (GDestroyNotify)dvbnet_if_free );
+
+	if ( dvbnet->place_id ) g_source_remove ( dvbnet->place_id );
+	if ( dvbnet->place ) dvbnet_place_free ( dvbnet->place );
+
+	dvbnet_meter_cancel ( dvbnet );
+
 	G_OBJECT_CLASS (dvbnet_parent_class)->finalize (object);
 }
 
 static void dvbnet_class_init ( DvbnetClass *class )
 {
 	G_APPLICATION_CLASS (class)->activate = dvbnet_activate;
+	G_APPLICATION_CLASS (class)->handle_local_options = dvbnet_handle_local_options;
 
 	G_OBJECT_CLASS (class)->finalize = dvbnet_finalize;
 }
@@ -710,11 +2336,11 @@ static Dvbnet * dvbnet_new (void)
 	return g_object_new ( DVBNET_TYPE_APPLICATION, /*"application-id", "org.gnome.dvbnet-gtk",*/ "flags", G_APPLICATION_FLAGS_NONE, NULL );
 }
 
-int main (void)
+int main ( int argc, char *argv[] )
 {
 	Dvbnet *app = dvbnet_new ();
 
-	int status = g_application_run ( G_APPLICATION (app), 0, NULL );
+	int status = g_application_run ( G_APPLICATION (app), argc, argv );
 
 	g_object_unref (app);
 